@@ -2,6 +2,10 @@
 #include <cstdlib>
 #include "src/arg_parser.h"
 #include "src/file_processor.h"
+#include "src/sampler.h"
+#include "src/heavy_hitters.h"
+#include "src/patterns.h"
+#include "src/splitter.h"
 
 int main(int argc, char* argv[])
 {
@@ -11,6 +15,27 @@ int main(int argc, char* argv[])
     try
     {
         ProgramOptions options = parse_arguments(argc, argv);
+
+        if (options.sampleBlocks > 0)
+        {
+            return sample_file(options);
+        }
+
+        if (!options.topField.empty() || !options.topCapture.empty())
+        {
+            return find_heavy_hitters(options);
+        }
+
+        if (options.showPatterns)
+        {
+            return cluster_patterns(options);
+        }
+
+        if (options.splitWindowMinutes > 0)
+        {
+            return split_by_time_window(options);
+        }
+
         return search_in_file(options);
     }
 
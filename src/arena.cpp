@@ -0,0 +1,58 @@
+// src/arena.cpp
+
+#include "arena.h"
+#include <algorithm>
+#include <cstring>
+
+MonotonicArena::MonotonicArena(std::size_t blockSize) : blockSize(std::max<std::size_t>(blockSize, 1))
+{
+}
+
+char* MonotonicArena::allocate(std::size_t size)
+{
+    if (size > blockSize)
+    {
+        // Oversized requests get their own block and the current block stays in use
+        blocks.push_back({std::make_unique<char[]>(size), size});
+        return blocks.back().data.get();
+    }
+
+    if (size > remaining)
+    {
+        blocks.push_back({std::make_unique<char[]>(blockSize), blockSize});
+        current = blocks.back().data.get();
+        remaining = blockSize;
+    }
+
+    char* result = current;
+    current += size;
+    remaining -= size;
+    return result;
+}
+
+std::string_view MonotonicArena::copy(std::string_view str)
+{
+    if (str.empty())
+    {
+        return {};
+    }
+
+    char* data = allocate(str.size());
+    std::memcpy(data, str.data(), str.size());
+    return {data, str.size()};
+}
+
+StringInterner::Id StringInterner::intern(std::string_view str)
+{
+    auto it = ids.find(str);
+    if (it != ids.end())
+    {
+        return it->second;
+    }
+
+    std::string_view stored = arena->copy(str);
+    Id id = static_cast<Id>(strings.size());
+    strings.push_back(stored);
+    ids.emplace(stored, id);
+    return id;
+}
@@ -0,0 +1,71 @@
+// src/arena.h
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+constexpr std::size_t ARENA_BLOCK_SIZE {64 * 1024};
+
+/*
+* Monotonic (bump pointer) arena
+*
+* Memory is taken from large blocks and only released all at once when the arena
+* is destroyed, so allocating is a pointer increment and the heap is touched once
+* per block instead of once per string.
+* One arena per query/thread: it is not thread-safe.
+*/
+class MonotonicArena
+{
+public:
+    explicit MonotonicArena(std::size_t blockSize = ARENA_BLOCK_SIZE);
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    MonotonicArena(MonotonicArena&&) = default;
+    MonotonicArena& operator=(MonotonicArena&&) = default;
+
+    // Copies the string into the arena, the view stays valid as long as the arena
+    std::string_view copy(std::string_view str);
+
+private:
+    char* allocate(std::size_t size);
+
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t size {0};
+    };
+
+    std::size_t blockSize;
+    std::vector<Block> blocks;
+    char* current {nullptr};
+    std::size_t remaining {0};
+};
+
+// Deduplicates strings into an arena and gives each one a dense id (0, 1, 2, ...)
+class StringInterner
+{
+public:
+    using Id = std::uint32_t;
+
+    explicit StringInterner(MonotonicArena& arena) : arena(&arena) {}
+
+    // Id of the string, copying it into the arena the first time it is seen
+    Id intern(std::string_view str);
+
+    std::string_view get(Id id) const { return strings[id]; }
+    std::size_t size() const { return strings.size(); }
+
+private:
+    MonotonicArena* arena;
+    std::unordered_map<std::string_view, Id> ids; // Keys point into the arena
+    std::vector<std::string_view> strings;
+};
+
+#endif // ARENA_H
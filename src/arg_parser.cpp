@@ -3,21 +3,29 @@
 #include "arg_parser.h"
 #include "date.h"
 #include "utils.h"
+#include "splitter.h"
 #include <stdexcept>
 #include <regex>
+#include <thread>
+#include <algorithm>
 
 ProgramOptions parse_arguments(int argc, char* argv[])
 {
     if (argc <= MIN_REQUIRED_ARGS)
     {
         throw std::runtime_error("Usage: " + std::string(argv[0]) + 
-                                " <input_file> <search_pattern1> [search_pattern2 ...] [-f/--log-format] [<log_format>] [-i] [-r] [-from <date>] [-to <date>]");
+                                " <input_file> <search_pattern1> [search_pattern2 ...] [-f/--log-format] [<log_format>] [-i] [-r] [-from <date>] [-to <date>] [--sample <blocks>] [--field <key> | --capture <regex>] [--top <k>] [--patterns] [--split-by <hour|minute|N-minutes>] [-o <dir>] [-j <threads>]");
     }
     
     ProgramOptions options;
     options.inputFilePath = argv[1];
     options.caseInsensitive = false;
     options.useRegex = false;
+    options.threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    // Flags that only apply to one mode, checked after the loop
+    bool topGiven {false};
+    bool outputDirectoryGiven {false};
 
     for (int i = FIRST_PATTERN_ARG_INDEX; i < argc; ++i)
     {
@@ -154,6 +162,139 @@ ProgramOptions parse_arguments(int argc, char* argv[])
             }
         }
 
+        else if (arg == "--sample")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after --sample flag.");
+            }
+
+            try
+            {
+                options.sampleBlocks = std::stoi(argv[++i]);
+            }
+
+            catch (const std::exception&)
+            {
+                throw std::runtime_error("Invalid integer value for --sample flag: " + std::string(argv[i]));
+            }
+
+            if (options.sampleBlocks <= 0)
+            {
+                throw std::runtime_error("Sample block count (--sample) must be positive.");
+            }
+        }
+
+        else if (arg == "--top")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after --top flag.");
+            }
+
+            try
+            {
+                options.topCount = std::stoi(argv[++i]);
+                topGiven = true;
+            }
+
+            catch (const std::exception&)
+            {
+                throw std::runtime_error("Invalid integer value for --top flag: " + std::string(argv[i]));
+            }
+
+            if (options.topCount <= 0)
+            {
+                throw std::runtime_error("Top count (--top) must be positive.");
+            }
+        }
+
+        else if (arg == "--field")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after --field flag.");
+            }
+            options.topField = argv[++i];
+        }
+
+        else if (arg == "--capture")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after --capture flag.");
+            }
+            options.topCapture = argv[++i];
+        }
+
+        else if (arg == "--patterns")
+        {
+            options.showPatterns = true;
+        }
+
+        else if (arg == "--split-by")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after --split-by flag.");
+            }
+            std::string windowStr = argv[++i];
+            if (windowStr == "hour") options.splitWindowMinutes = 60;
+            else if (windowStr == "minute") options.splitWindowMinutes = 1;
+            else
+            {
+                // N-minutes, Ex: "15-minutes"
+                const std::string suffix = "-minutes";
+                bool hasSuffix = windowStr.size() > suffix.size() &&
+                                 windowStr.compare(windowStr.size() - suffix.size(), suffix.size(), suffix) == 0;
+                std::string number = hasSuffix ? windowStr.substr(0, windowStr.size() - suffix.size()) : "";
+
+                if (number.empty() || number.find_first_not_of("0123456789") != std::string::npos || number.size() > 4)
+                {
+                    throw std::runtime_error("Unknown split window: " + windowStr + " (use hour, minute or N-minutes)");
+                }
+                options.splitWindowMinutes = std::stoi(number);
+            }
+
+            if (options.splitWindowMinutes <= 0 || options.splitWindowMinutes > MAX_SPLIT_WINDOW_MINUTES)
+            {
+                throw std::runtime_error("Split window must be between 1 minute and 24 hours: " + windowStr);
+            }
+        }
+
+        else if (arg == "-o" || arg == "--output-dir")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after -o/--output-dir flag.");
+            }
+            options.outputDirectory = argv[++i];
+            outputDirectoryGiven = true;
+        }
+
+        else if (arg == "-j" || arg == "--threads")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value after -j/--threads flag.");
+            }
+
+            try
+            {
+                options.threadCount = std::stoi(argv[++i]);
+            }
+
+            catch (const std::exception&)
+            {
+                throw std::runtime_error("Invalid integer value for -j flag: " + std::string(argv[i]));
+            }
+
+            if (options.threadCount <= 0)
+            {
+                throw std::runtime_error("Thread count (-j) must be positive.");
+            }
+        }
+
         else
         {
             options.searchPatterns.push_back(arg);
@@ -181,6 +322,41 @@ ProgramOptions parse_arguments(int argc, char* argv[])
         }
     }
 
+    if (!options.topField.empty() && !options.topCapture.empty())
+    {
+        throw std::runtime_error("Use either --field or --capture, not both.");
+    }
+
+    // Modes are exclusive, don't silently ignore one of them
+    const bool topMode = !options.topField.empty() || !options.topCapture.empty();
+    const int modeCount = (options.sampleBlocks > 0) + topMode + options.showPatterns + (options.splitWindowMinutes > 0);
+    if (modeCount > 1)
+    {
+        throw std::runtime_error("Only one of --sample, --field/--capture, --patterns and --split-by can be used at a time.");
+    }
+
+    if (outputDirectoryGiven && options.splitWindowMinutes == 0)
+    {
+        throw std::runtime_error("-o/--output-dir requires --split-by.");
+    }
+
+    if (topGiven && !topMode)
+    {
+        throw std::runtime_error("--top requires --field or --capture.");
+    }
+
+    if (!options.topCapture.empty())
+    {
+        try
+        {
+            std::regex testRegex(options.topCapture, options.caseInsensitive ? std::regex::icase : std::regex::ECMAScript);
+        }
+        catch (const std::regex_error& e)
+        {
+            throw std::runtime_error("Invalid capture pattern: '" + options.topCapture + "': " + e.what());
+        }
+    }
+
     // Optimization Update: Pre-detect date format from the log file
     options.detectedDateFormat = detect_date_format_from_file(options.inputFilePath);
 
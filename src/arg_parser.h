@@ -33,6 +33,24 @@ struct ProgramOptions
     // New: Context lines (grep style (e.g., -A -B -C))
     int beforeContext {0}; // -B flag
     int afterContext {0};  // -A flag
+
+    // New: Sampling mode, number of evenly spaced blocks to read (0 = full scan)
+    int sampleBlocks {0}; // --sample flag
+
+    // New: Top-K values of a key=value field or regex capture among matching lines
+    int topCount {20};       // --top flag
+    std::string topField;    // --field flag
+    std::string topCapture;  // --capture flag
+
+    // New: Group matching lines into message templates
+    bool showPatterns {false}; // --patterns flag
+
+    // New: Write matching lines into one file per time window
+    int splitWindowMinutes {0};            // --split-by flag (0 = off)
+    std::string outputDirectory {"."};     // -o/--output-dir flag
+
+    // Worker threads for chunked modes (defaults to hardware concurrency)
+    int threadCount {1}; // -j flag
 };
 
 ProgramOptions parse_arguments(int argc, char* argv[]);
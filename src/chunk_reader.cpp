@@ -0,0 +1,82 @@
+// src/chunk_reader.cpp
+
+#include "chunk_reader.h"
+#include <filesystem>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+std::uintmax_t get_file_size(const std::string& filePath)
+{
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filePath, ec);
+    if (ec)
+    {
+        throw std::runtime_error("Failed to read size of file: " + filePath);
+    }
+    return size;
+}
+
+std::uintmax_t seek_to_line_start(std::ifstream& file, std::uintmax_t offset, std::uintmax_t fileSize)
+{
+    file.clear(); // Reset EOF from a previous read
+
+    if (offset == 0)
+    {
+        file.seekg(0);
+        return 0;
+    }
+    if (offset >= fileSize)
+    {
+        return fileSize;
+    }
+
+    // Look at the byte before offset: if it is a newline we are already at a line start,
+    // otherwise skip the rest of the partial line
+    file.seekg(static_cast<std::streamoff>(offset - 1));
+    if (file.get() != '\n')
+    {
+        file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+
+    if (!file || file.eof())
+    {
+        file.clear();
+        return fileSize;
+    }
+    return static_cast<std::uintmax_t>(file.tellg());
+}
+
+std::vector<FileChunk> split_into_line_chunks(const std::string& filePath, std::size_t count)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    const std::uintmax_t fileSize = get_file_size(filePath);
+
+    // Don't hand out chunks smaller than MIN_CHUNK_SIZE
+    count = std::max<std::size_t>(1, std::min<std::uintmax_t>(count, fileSize / MIN_CHUNK_SIZE));
+
+    std::vector<FileChunk> chunks;
+    chunks.reserve(count);
+
+    std::uintmax_t begin {0};
+    for (std::size_t i = 1; i <= count && begin < fileSize; ++i)
+    {
+        std::uintmax_t end = (i == count) ? fileSize : seek_to_line_start(file, fileSize / count * i, fileSize);
+        if (end > begin)
+        {
+            chunks.push_back({begin, end});
+            begin = end;
+        }
+    }
+
+    if (chunks.empty())
+    {
+        chunks.push_back({0, fileSize}); // Empty file
+    }
+    return chunks;
+}
@@ -0,0 +1,48 @@
+// src/chunk_reader.h
+
+#ifndef CHUNK_READER_H
+#define CHUNK_READER_H
+
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <vector>
+
+// Files smaller than this per thread are not worth splitting
+constexpr std::uintmax_t MIN_CHUNK_SIZE {1024 * 1024};
+
+// Byte range [begin, end) of a file; both ends lie on line boundaries
+struct FileChunk
+{
+    std::uintmax_t begin {0};
+    std::uintmax_t end {0};
+};
+
+// Size of the file in bytes (throws if it cannot be read)
+std::uintmax_t get_file_size(const std::string& filePath);
+
+// Moves the stream to the first line that starts at or after offset.
+// Returns the new position, or fileSize if no line starts there.
+std::uintmax_t seek_to_line_start(std::ifstream& file, std::uintmax_t offset, std::uintmax_t fileSize);
+
+// Splits the file into at most count line-aligned chunks of roughly equal size
+std::vector<FileChunk> split_into_line_chunks(const std::string& filePath, std::size_t count);
+
+// Calls onLine(line) for every line of the chunk. The stream must already be open.
+template <typename OnLine>
+void read_chunk_lines(std::ifstream& file, const FileChunk& chunk, OnLine onLine)
+{
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(chunk.begin));
+
+    std::string line;
+    std::uintmax_t position = chunk.begin;
+
+    while (position < chunk.end && std::getline(file, line))
+    {
+        position += line.size() + 1; // +1 for the newline consumed by getline
+        onLine(line);
+    }
+}
+
+#endif // CHUNK_READER_H
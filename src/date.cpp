@@ -64,18 +64,89 @@ std::optional<std::chrono::system_clock::time_point> parse_log_timestamp(const s
     return std::chrono::system_clock::from_time_t(std::mktime(&tm));
 }
 
+namespace
+{
+    // Reads exactly `count` digits starting at pos
+    bool read_digits(std::string_view str, std::size_t pos, std::size_t count, int& value)
+    {
+        value = 0;
+        for (std::size_t i = pos; i < pos + count; ++i)
+        {
+            if (str[i] < '0' || str[i] > '9')
+                return false;
+            value = value * 10 + (str[i] - '0');
+        }
+        return true;
+    }
+
+    // mktime() is the expensive part of parsing (time zone lookup), but consecutive
+    // log lines nearly always share the same hour. DST changes happen on hour boundaries,
+    // so the start of the hour can be cached and minutes/seconds added to it.
+    struct HourCache
+    {
+        int year {-1};
+        int month {-1};
+        int day {-1};
+        int hour {-1};
+        std::time_t hourStart {0};
+    };
+
+    thread_local HourCache hourCache; // One per thread, no locking
+}
+
 // Extract timestamp from a log line using pre-detected format
-std::optional<std::chrono::system_clock::time_point> extract_timestamp(const std::string& line, LogDateFormat format)
+std::optional<std::chrono::system_clock::time_point> extract_timestamp(std::string_view line, LogDateFormat format)
 {
     // Log timestamp length check
     if (line.size() < TIMESTAMP_PREFIX_LENGTH)
         return std::nullopt; 
 
-    std::string prefix = line.substr(0, TIMESTAMP_PREFIX_LENGTH); // 
-    
-    // For performance, no more regex detection here - just parse with know format.
+    // For performance, the fixed-width prefix is read in place (no substr, no stringstream)
+    // Layout: date part at 0-9, ' ' at 10, "HH:MM:SS" at 11-18
+    std::size_t yearPos, monthPos, dayPos;
+    switch (format)
+    {
+        case LogDateFormat::YYYY_MM_DD_HH_MM_SS:
+            yearPos = 0; monthPos = 5; dayPos = 8;
+            break;
+        case LogDateFormat::DD_MM_YYYY_HH_MM_SS:
+            dayPos = 0; monthPos = 3; yearPos = 6;
+            break;
+        case LogDateFormat::MM_DD_YYYY_HH_MM_SS:
+            monthPos = 0; dayPos = 3; yearPos = 6;
+            break;
+        default:
+            return std::nullopt; // Unsupported format
+    }
+
+    const std::size_t firstSep = (yearPos == 0) ? 4 : 2;
+    const std::size_t secondSep = (yearPos == 0) ? 7 : 5;
+    if (line[firstSep] != '-' || line[secondSep] != '-' || line[10] != ' ' || line[13] != ':' || line[16] != ':')
+        return std::nullopt;
+
+    int year, month, day, hour, minute, second;
+    if (!read_digits(line, yearPos, 4, year) || !read_digits(line, monthPos, 2, month) ||
+        !read_digits(line, dayPos, 2, day) || !read_digits(line, 11, 2, hour) ||
+        !read_digits(line, 14, 2, minute) || !read_digits(line, 17, 2, second))
+        return std::nullopt;
+
+    // Same ranges std::get_time accepts
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60)
+        return std::nullopt;
 
-    return parse_log_timestamp(prefix, format); // Call parsing function
+    if (year != hourCache.year || month != hourCache.month || day != hourCache.day || hour != hourCache.hour)
+    {
+        std::tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_isdst = -1; // Let mktime determine if DST is in effect
+
+        hourCache = {year, month, day, hour, std::mktime(&tm)};
+    }
+
+    return std::chrono::system_clock::from_time_t(hourCache.hourStart + minute * 60 + second);
 }
 
 // New Function: Detect date format from a log file by reading the first few lines
@@ -102,3 +173,15 @@ LogDateFormat detect_date_format_from_file(const std::string& filePath)
 
     return LogDateFormat::UNKNOWN; 
 }
+
+// Format a time point as "YYYY-MM-DD HH:MM:SS" (local time, same as parse_log_timestamp)
+std::string format_timestamp(std::chrono::system_clock::time_point timePoint)
+{
+    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
+    std::tm tm = {};
+    localtime_r(&time, &tm); // Thread-safe variant of localtime
+
+    char buffer[TIMESTAMP_PREFIX_LENGTH + 1];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    return buffer;
+}
@@ -3,6 +3,7 @@
 #define DATE_H
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <chrono>
 
@@ -22,8 +23,9 @@ LogDateFormat detect_date_format(const std::string& dateStr);
 std::optional<std::chrono::system_clock::time_point> parse_log_timestamp(
     const std::string& dateStr, 
     LogDateFormat format);
-std::optional<std::chrono::system_clock::time_point> extract_timestamp(const std::string& line, LogDateFormat format);
+std::optional<std::chrono::system_clock::time_point> extract_timestamp(std::string_view line, LogDateFormat format);
 LogDateFormat detect_date_format_from_file(const std::string& filePath);
+std::string format_timestamp(std::chrono::system_clock::time_point timePoint);
 
 
 #endif // DATE_H
\ No newline at end of file
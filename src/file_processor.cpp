@@ -3,11 +3,47 @@
 #include "file_processor.h"
 #include "utils.h"
 #include "date.h"
+#include "matcher.h"
 #include <iostream>
 #include <fstream>
-#include <regex>
+#include <vector>
 #include <cstdlib>
 
+namespace
+{
+    // Fixed-size ring buffer for before-context lines.
+    // Slots are overwritten in place, so a slot keeps its string capacity and
+    // storing a line stops allocating once every slot has held a long enough line.
+    class ContextRing
+    {
+    public:
+        explicit ContextRing(std::size_t capacity) : slots(capacity) {}
+
+        void push(int lineNumber, const std::string& line)
+        {
+            auto& slot = slots[(start + count) % slots.size()];
+            slot.first = lineNumber;
+            slot.second.assign(line); // Reuses the slot's buffer
+
+            if (count < slots.size())
+                ++count;
+            else
+                start = (start + 1) % slots.size(); // Full: the oldest line was overwritten
+        }
+
+        void clear() { start = 0; count = 0; }
+        std::size_t size() const { return count; }
+
+        // i = 0 is the oldest stored line
+        const std::pair<int, std::string>& operator[](std::size_t i) const { return slots[(start + i) % slots.size()]; }
+
+    private:
+        std::vector<std::pair<int, std::string>> slots;
+        std::size_t start {0};
+        std::size_t count {0};
+    };
+}
+
 int search_in_file(const ProgramOptions& options)
 {
     /*
@@ -16,9 +52,9 @@ int search_in_file(const ProgramOptions& options)
     * This function implements grep-style context lines (-A, -B, -C flags).
     * 
     * 1. Ring Buffer (Before-Context):
-    *   - Continously stores the last N lines in a deque (instead of vector for faster operations)
+    *   - Continously stores the last N lines in a fixed ring of N slots (see ContextRing)
     *   - When match found -> dump buffer, then clear it
-    *   - Deque has O(1) for push_back/pop_front 
+    *   - O(1) push, and slots reuse their memory so no allocation per line
     * 
     * 2. Countdown Timer (After-Context):
     *   - After a match, print next N lines regardless of pattern
@@ -51,31 +87,11 @@ int search_in_file(const ProgramOptions& options)
         throw std::runtime_error("Failed to open file: " + options.inputFilePath);
     }
 
-    // Precompute lowercase patterns if case insensitive
-    std::vector<std::string> lowerCasePatterns;
-    if (options.caseInsensitive && !options.useRegex)
-    {
-        lowerCasePatterns.reserve(options.searchPatterns.size());
-
-        for (const auto& pattern : options.searchPatterns)
-        {
-            lowerCasePatterns.push_back(to_lower(pattern));
-        }
-    }
-
-    // Compile regex patterns if needed
-    std::vector<std::regex> regexPatterns;
-    if (options.useRegex)
-    {
-        for (const auto& pattern : options.searchPatterns)
-        {
-            regexPatterns.emplace_back(pattern, options.caseInsensitive ? std::regex::icase : std::regex::ECMAScript);
-        }
-    }
+    const LineMatcher matcher(options);
 
     // Context lines implementation
     // Ring buffer for before-context lines (-B flag)
-    std::deque<std::pair<int, std::string>> beforeBuffer;
+    ContextRing beforeBuffer(static_cast<std::size_t>(options.beforeContext));
 
     int afterContextRemaining {0}; // Countdown timer for after-context lines (-A flag)
 
@@ -102,45 +118,13 @@ int search_in_file(const ProgramOptions& options)
         if (ts)
         {
             ++linesWithTimestamps;
-            if (options.fromTime && *ts < *(options.fromTime))
-            {
-                continue; // Skip lines before fromTime
-            }
-            if (options.toTime && *ts > *(options.toTime))
-            {
-                continue; // Skip lines after toTime
-            }
         }
-
-        bool found = false;
-
-        if (options.useRegex)
+        if (!matcher.within_date_range(ts))
         {
-            // Use regex search
-            for (const auto& regexPattern : regexPatterns)
-            {
-                if (std::regex_search(line, regexPattern))
-                {
-                    found = true;
-                    break;
-                }
-            }
+            continue;
         }
 
-        else
-        {
-            const std::string searchLine = options.caseInsensitive ? to_lower(line) : line;
-            const auto& patternsToUse = options.caseInsensitive ? lowerCasePatterns : options.searchPatterns;
-
-            for (const auto& pattern : patternsToUse)
-            {
-                if (searchLine.find(pattern) != std::string::npos)
-                {
-                    found = true;
-                    break;
-                }
-            }
-        }
+        bool found = matcher.matches(line);
 
         if (found)
         {
@@ -153,8 +137,10 @@ int search_in_file(const ProgramOptions& options)
 
             // Step 2: Dump ring buffer (before context)
             // Loop through stored lines in beforeBuffer
-            for (const auto& [bufLineNum, bufLine] : beforeBuffer)
+            for (std::size_t i = 0; i < beforeBuffer.size(); ++i)
             {
+                const auto& [bufLineNum, bufLine] = beforeBuffer[i];
+
                 // Deduplication check
                 // If matches are close, avoid re-printing same context lines
                 if (bufLineNum > lastPrintedLine)
@@ -200,15 +186,10 @@ int search_in_file(const ProgramOptions& options)
             // Store line in before buffer
             if (options.beforeContext > 0)
             {
-                beforeBuffer.push_back({lineNumber, line}); // O(1)
-                
-                // Maintain buffer size (sliding window)
-                // Ex: buffer size=3, we have 4 lines, pop the oldest (front)
+                // Sliding window: once full, the oldest line is overwritten
+                // Ex: buffer size=3, we have 4 lines, drop the oldest
                 // [line10, line11, line12] + line13 -> [line11, line12, line13]
-                if (static_cast<int>(beforeBuffer.size()) > options.beforeContext)
-                {
-                    beforeBuffer.pop_front(); // O(1)
-                }
+                beforeBuffer.push(lineNumber, line); // O(1)
             }
         }
     }
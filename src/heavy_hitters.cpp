@@ -0,0 +1,283 @@
+// src/heavy_hitters.cpp
+
+#include "heavy_hitters.h"
+#include "chunk_reader.h"
+#include "matcher.h"
+#include "date.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <regex>
+#include <cctype>
+#include <cstdlib>
+
+SpaceSavingSketch::SpaceSavingSketch(std::size_t capacity) : capacity(std::max<std::size_t>(capacity, 1))
+{
+    counters.reserve(this->capacity);
+}
+
+void SpaceSavingSketch::add(std::string_view value, std::uint64_t count)
+{
+    totalCount += count;
+    scratch.assign(value.data(), value.size());
+
+    auto it = counters.find(scratch);
+    if (it != counters.end())
+    {
+        // Known value: bump its counter and move it in the ordering.
+        // The set node is reused (extract/insert), so this does not allocate.
+        auto node = byCount.extract({it->second.count, &it->first});
+        it->second.count += count;
+        node.value().first = it->second.count;
+        byCount.insert(std::move(node));
+        return;
+    }
+
+    Counter counter {count, 0};
+    if (counters.size() >= capacity)
+    {
+        // Full: the new value takes over the smallest counter
+        auto smallest = byCount.begin();
+        counter.count += smallest->first;
+        counter.error = smallest->first;
+        counters.erase(*smallest->second);
+        byCount.erase(smallest);
+        evicted = true;
+    }
+
+    auto inserted = counters.emplace(scratch, counter).first;
+    byCount.insert({counter.count, &inserted->first});
+}
+
+void SpaceSavingSketch::merge(const SpaceSavingSketch& other)
+{
+    /*
+    * Mergeable summaries (Agarwal et al.):
+    * A value missing from one sketch may still have occurred up to that sketch's
+    * smallest count, so it is added as both count and error. Then keep the largest counters.
+    */
+    const std::uint64_t ownFloor = floor_count();
+    const std::uint64_t otherFloor = other.floor_count();
+
+    for (auto& [value, counter] : counters)
+    {
+        auto match = other.counters.find(value);
+        if (match != other.counters.end())
+        {
+            counter.count += match->second.count;
+            counter.error += match->second.error;
+        }
+        else
+        {
+            counter.count += otherFloor;
+            counter.error += otherFloor;
+        }
+    }
+
+    for (const auto& [value, counter] : other.counters)
+    {
+        if (counters.find(value) == counters.end())
+        {
+            counters.emplace(value, Counter {counter.count + ownFloor, counter.error + ownFloor});
+        }
+    }
+
+    totalCount += other.totalCount;
+    evicted = evicted || other.evicted;
+
+    if (counters.size() > capacity)
+    {
+        // Drop the smallest counters until we are back at capacity
+        std::vector<std::pair<std::uint64_t, std::string>> ranked;
+        ranked.reserve(counters.size());
+        for (const auto& [value, counter] : counters)
+        {
+            ranked.emplace_back(counter.count, value);
+        }
+        std::nth_element(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(capacity), ranked.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (auto it = ranked.begin() + static_cast<std::ptrdiff_t>(capacity); it != ranked.end(); ++it)
+        {
+            counters.erase(it->second);
+        }
+        evicted = true;
+    }
+
+    rebuild_order();
+}
+
+std::vector<HeavyHitter> SpaceSavingSketch::top(std::size_t k) const
+{
+    std::vector<HeavyHitter> result;
+    result.reserve(std::min(k, counters.size()));
+
+    for (auto it = byCount.rbegin(); it != byCount.rend() && result.size() < k; ++it)
+    {
+        const Counter& counter = counters.at(*it->second);
+        result.push_back({*it->second, counter.count, counter.error});
+    }
+    return result;
+}
+
+std::uint64_t SpaceSavingSketch::floor_count() const
+{
+    return (evicted && !byCount.empty()) ? byCount.begin()->first : 0;
+}
+
+void SpaceSavingSketch::rebuild_order()
+{
+    byCount.clear();
+    for (const auto& [value, counter] : counters)
+    {
+        byCount.insert({counter.count, &value});
+    }
+}
+
+namespace
+{
+    struct ChunkResult
+    {
+        SpaceSavingSketch sketch;
+        std::uint64_t matchedLines {0};
+    };
+
+    bool is_value_terminator(char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) || c == ',' || c == ';' || c == ')' || c == ']' || c == '"';
+    }
+
+    // Value of "key=value" in the line, the key must start a token (so "id" doesn't match "userId=")
+    std::optional<std::string_view> extract_field_value(std::string_view line, std::string_view key)
+    {
+        std::size_t pos = 0;
+        while ((pos = line.find(key, pos)) != std::string_view::npos)
+        {
+            std::size_t valueStart = pos + key.size();
+            bool startsToken = pos == 0 || !std::isalnum(static_cast<unsigned char>(line[pos - 1]));
+
+            if (startsToken && valueStart < line.size() && line[valueStart] == '=')
+            {
+                ++valueStart;
+                std::size_t valueEnd = valueStart;
+                while (valueEnd < line.size() && !is_value_terminator(line[valueEnd]))
+                {
+                    ++valueEnd;
+                }
+                if (valueEnd > valueStart)
+                {
+                    return line.substr(valueStart, valueEnd - valueStart);
+                }
+            }
+            ++pos;
+        }
+        return std::nullopt;
+    }
+
+    ChunkResult process_chunk(const ProgramOptions& options, const LineMatcher& matcher,
+                              const std::regex* captureRegex, const FileChunk& chunk, std::size_t capacity)
+    {
+        std::ifstream inputFile(options.inputFilePath, std::ios::binary);
+        if (!inputFile.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + options.inputFilePath);
+        }
+
+        ChunkResult result {SpaceSavingSketch(capacity), 0};
+        std::smatch captured;
+
+        read_chunk_lines(inputFile, chunk, [&](const std::string& line)
+        {
+            auto ts = extract_timestamp(line, options.detectedDateFormat);
+            if (!matcher.within_date_range(ts) || !matcher.matches(line))
+            {
+                return;
+            }
+            ++result.matchedLines;
+
+            if (captureRegex)
+            {
+                if (std::regex_search(line, captured, *captureRegex))
+                {
+                    // First capture group if the pattern has one, otherwise the whole match
+                    const auto& group = captured.size() > 1 ? captured[1] : captured[0];
+                    if (group.matched && group.length() > 0)
+                    {
+                        result.sketch.add(std::string_view(&*group.first, static_cast<std::size_t>(group.length())));
+                    }
+                }
+            }
+            else if (auto value = extract_field_value(line, options.topField))
+            {
+                result.sketch.add(*value);
+            }
+        });
+
+        return result;
+    }
+}
+
+int find_heavy_hitters(const ProgramOptions& options)
+{
+    /*
+    * HEAVY HITTER ALGORITHM
+    *
+    * 1. Split the file into line-aligned chunks, one per thread
+    * 2. Each thread matches its lines and feeds the extracted value into its own SpaceSavingSketch
+    *    (no locking, memory per thread is fixed by the sketch capacity)
+    * 3. Sketches are merged in chunk order and the largest K counters are printed
+    */
+
+    const LineMatcher matcher(options);
+
+    std::optional<std::regex> captureRegex;
+    if (!options.topCapture.empty())
+    {
+        captureRegex.emplace(options.topCapture, options.caseInsensitive ? std::regex::icase : std::regex::ECMAScript);
+    }
+
+    const std::size_t topCount = static_cast<std::size_t>(options.topCount);
+    const std::size_t capacity = std::max(topCount * HEAVY_HITTER_CAPACITY_FACTOR, HEAVY_HITTER_MIN_CAPACITY);
+
+    auto chunks = split_into_line_chunks(options.inputFilePath, static_cast<std::size_t>(options.threadCount));
+
+    std::vector<std::future<ChunkResult>> workers;
+    workers.reserve(chunks.size());
+    for (const auto& chunk : chunks)
+    {
+        workers.push_back(std::async(std::launch::async, process_chunk, std::cref(options), std::cref(matcher),
+                                     captureRegex ? &*captureRegex : nullptr, chunk, capacity));
+    }
+
+    SpaceSavingSketch merged(capacity);
+    std::uint64_t matchedLines {0};
+    for (auto& worker : workers)
+    {
+        ChunkResult result = worker.get(); // Rethrows worker exceptions
+        merged.merge(result.sketch);
+        matchedLines += result.matchedLines;
+    }
+
+    const std::string source = captureRegex ? "capture '" + options.topCapture + "'" : "field '" + options.topField + "'";
+    const auto hitters = merged.top(topCount);
+
+    std::cout << "Top " << hitters.size() << " values of " << source << " among " << matchedLines
+              << " matching line(s), " << merged.total() << " with a value"
+              << (merged.is_exact() ? " (exact counts)" : " (approximate counts)") << ":\n\n";
+
+    for (std::size_t i = 0; i < hitters.size(); ++i)
+    {
+        const auto& hitter = hitters[i];
+        std::cout << std::right << std::setw(4) << i + 1 << ". " << std::setw(10) << hitter.count;
+        if (hitter.error > 0)
+        {
+            std::cout << " (max error " << hitter.error << ")";
+        }
+        std::cout << "  " << hitter.value << '\n';
+    }
+
+    std::cout << std::flush;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+// src/heavy_hitters.h
+
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+#include "arg_parser.h"
+
+// Counters tracked per requested top entry (the sketch keeps K * factor counters)
+constexpr std::size_t HEAVY_HITTER_CAPACITY_FACTOR {10};
+constexpr std::size_t HEAVY_HITTER_MIN_CAPACITY {1000};
+
+struct HeavyHitter
+{
+    std::string value;
+    std::uint64_t count {0}; // Upper bound of the true count
+    std::uint64_t error {0}; // count - error is a lower bound (0 = exact)
+};
+
+/*
+* Space-Saving sketch (Metwally et al.)
+*
+* Keeps at most `capacity` counters, so memory does not grow with the input.
+* While fewer than `capacity` distinct values were seen every count is exact.
+* Once full, a new value replaces the smallest counter and inherits its count as error,
+* so any value occurring more than total/capacity times is guaranteed to be kept.
+*
+* Sketches built on different parts of a file can be merged (one per thread).
+*/
+class SpaceSavingSketch
+{
+public:
+    explicit SpaceSavingSketch(std::size_t capacity);
+
+    void add(std::string_view value, std::uint64_t count = 1);
+    void merge(const SpaceSavingSketch& other);
+
+    // Largest k counters, highest count first
+    std::vector<HeavyHitter> top(std::size_t k) const;
+
+    // True while no counter was ever evicted
+    bool is_exact() const { return !evicted; }
+    std::uint64_t total() const { return totalCount; }
+
+private:
+    struct Counter
+    {
+        std::uint64_t count {0};
+        std::uint64_t error {0};
+    };
+
+    using CounterMap = std::unordered_map<std::string, Counter>;
+
+    // Count of the smallest counter if the sketch has evicted anything, else 0
+    std::uint64_t floor_count() const;
+    void rebuild_order();
+
+    std::size_t capacity;
+    CounterMap counters;
+    std::set<std::pair<std::uint64_t, const std::string*>> byCount; // Ascending, min at begin()
+    std::string scratch; // Reused lookup key, adding a known value does not allocate
+    std::uint64_t totalCount {0};
+    bool evicted {false};
+};
+
+// Top-K values of --field / --capture among matching lines
+int find_heavy_hitters(const ProgramOptions& options);
+
+#endif // HEAVY_HITTERS_H
@@ -0,0 +1,82 @@
+// src/matcher.cpp
+
+#include "matcher.h"
+#include "utils.h"
+
+LineMatcher::LineMatcher(const ProgramOptions& options) : options(options)
+{
+    // Precompute lowercase patterns if case insensitive
+    if (options.caseInsensitive && !options.useRegex)
+    {
+        lowerCasePatterns.reserve(options.searchPatterns.size());
+
+        for (const auto& pattern : options.searchPatterns)
+        {
+            lowerCasePatterns.push_back(to_lower(pattern));
+        }
+    }
+
+    // Compile regex patterns if needed
+    if (options.useRegex)
+    {
+        for (const auto& pattern : options.searchPatterns)
+        {
+            regexPatterns.emplace_back(pattern, options.caseInsensitive ? std::regex::icase : std::regex::ECMAScript);
+        }
+    }
+}
+
+bool LineMatcher::matches(const std::string& line) const
+{
+    if (options.useRegex)
+    {
+        // Use regex search
+        for (const auto& regexPattern : regexPatterns)
+        {
+            if (std::regex_search(line, regexPattern))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Search the line in place, no lowered or copied line per call
+    if (options.caseInsensitive)
+    {
+        for (const auto& pattern : lowerCasePatterns)
+        {
+            if (contains_ignore_case(line, pattern))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (const auto& pattern : options.searchPatterns)
+    {
+        if (line.find(pattern) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LineMatcher::within_date_range(const std::optional<std::chrono::system_clock::time_point>& ts) const
+{
+    if (!ts)
+    {
+        return true; // Stack traces, multi-line messages etc. are kept
+    }
+    if (options.fromTime && *ts < *(options.fromTime))
+    {
+        return false; // Skip lines before fromTime
+    }
+    if (options.toTime && *ts > *(options.toTime))
+    {
+        return false; // Skip lines after toTime
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+// src/matcher.h
+
+#ifndef MATCHER_H
+#define MATCHER_H
+
+#include <string>
+#include <vector>
+#include <regex>
+#include <optional>
+#include <chrono>
+#include "arg_parser.h"
+
+// Precompiled form of the search patterns and date range in ProgramOptions.
+// Built once per query so every mode (search, sampling, ...) shares the same matching rules.
+class LineMatcher
+{
+public:
+    explicit LineMatcher(const ProgramOptions& options);
+
+    // True if the line contains any of the search patterns
+    bool matches(const std::string& line) const;
+
+    // True if the timestamp lies inside [-from, -to]. Lines without a timestamp always pass.
+    bool within_date_range(const std::optional<std::chrono::system_clock::time_point>& ts) const;
+
+private:
+    const ProgramOptions& options;
+    std::vector<std::string> lowerCasePatterns;
+    std::vector<std::regex> regexPatterns;
+};
+
+#endif // MATCHER_H
@@ -0,0 +1,341 @@
+// src/patterns.cpp
+
+#include "patterns.h"
+#include "arena.h"
+#include "chunk_reader.h"
+#include "matcher.h"
+#include "utils.h"
+#include "date.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <optional>
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+
+namespace
+{
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    bool is_digit(char c) { return std::isdigit(static_cast<unsigned char>(c)); }
+    bool is_alnum(char c) { return std::isalnum(static_cast<unsigned char>(c)); }
+    bool is_hex(char c) { return std::isxdigit(static_cast<unsigned char>(c)); }
+
+    // Length of a dotted IPv4 address starting at pos, 0 if there is none
+    std::size_t match_ipv4(std::string_view str, std::size_t pos)
+    {
+        std::size_t i = pos;
+        for (int group = 0; group < 4; ++group)
+        {
+            if (group > 0)
+            {
+                if (i >= str.size() || str[i] != '.')
+                    return 0;
+                ++i;
+            }
+
+            std::size_t digits = 0;
+            while (i < str.size() && is_digit(str[i]) && digits < 3)
+            {
+                ++i;
+                ++digits;
+            }
+            if (digits == 0)
+                return 0;
+        }
+
+        // Must end the token (no "1.2.3.4.5" or "1.2.3.4abc")
+        if (i < str.size() && (is_alnum(str[i]) || (str[i] == '.' && i + 1 < str.size() && is_digit(str[i + 1]))))
+            return 0;
+
+        return i - pos;
+    }
+
+    // Length of a UUID (8-4-4-4-12 hex digits) starting at pos, 0 if there is none
+    std::size_t match_uuid(std::string_view str, std::size_t pos)
+    {
+        constexpr std::size_t UUID_LENGTH {36};
+        if (str.size() - pos < UUID_LENGTH)
+            return 0;
+
+        for (std::size_t i = 0; i < UUID_LENGTH; ++i)
+        {
+            char c = str[pos + i];
+            bool dash = (i == 8 || i == 13 || i == 18 || i == 23);
+            if (dash ? c != '-' : !is_hex(c))
+                return 0;
+        }
+
+        if (pos + UUID_LENGTH < str.size() && is_alnum(str[pos + UUID_LENGTH]))
+            return 0;
+
+        return UUID_LENGTH;
+    }
+
+    // Appends the normalized form of one alphanumeric word
+    void normalize_word(std::string_view word, std::string& out)
+    {
+        std::size_t digits = std::count_if(word.begin(), word.end(), is_digit);
+
+        if (digits == 0)
+        {
+            out.append(word); // Plain word
+            return;
+        }
+        if (digits == word.size())
+        {
+            out.append("<NUM>");
+            return;
+        }
+        if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X') &&
+            std::all_of(word.begin() + 2, word.end(), is_hex))
+        {
+            out.append("<HEX>");
+            return;
+        }
+        if (word.size() >= HEX_TOKEN_MIN_LENGTH && std::all_of(word.begin(), word.end(), is_hex))
+        {
+            out.append("<HEX>");
+            return;
+        }
+        if (word.size() >= OPAQUE_TOKEN_MIN_LENGTH)
+        {
+            out.append("<ID>");
+            return;
+        }
+
+        // Letter prefix + number, Ex: "TXN98455" -> "TXN<NUM>"
+        auto firstDigit = std::find_if(word.begin(), word.end(), is_digit);
+        if (std::all_of(firstDigit, word.end(), is_digit))
+        {
+            out.append(word.substr(0, static_cast<std::size_t>(firstDigit - word.begin())));
+            out.append("<NUM>");
+            return;
+        }
+
+        // Number + unit, Ex: "18ms" -> "<NUM>ms"
+        auto firstLetter = std::find_if_not(word.begin(), word.end(), is_digit);
+        if (firstLetter != word.begin() && std::none_of(firstLetter, word.end(), is_digit))
+        {
+            out.append("<NUM>");
+            out.append(word.substr(static_cast<std::size_t>(firstLetter - word.begin())));
+            return;
+        }
+
+        out.append(word);
+    }
+
+    // Message part of a line, without the leading "YYYY-MM-DD HH:MM:SS[.fff] "
+    std::string_view strip_timestamp(std::string_view line)
+    {
+        std::size_t pos = TIMESTAMP_PREFIX_LENGTH;
+        if (pos < line.size() && (line[pos] == '.' || line[pos] == ','))
+        {
+            ++pos;
+            while (pos < line.size() && is_digit(line[pos]))
+                ++pos;
+        }
+        while (pos < line.size() && line[pos] == ' ')
+            ++pos;
+
+        return line.substr(std::min(pos, line.size()));
+    }
+
+    struct TemplateStats
+    {
+        std::uint64_t count {0};
+        std::optional<TimePoint> first;
+        std::optional<TimePoint> last;
+        std::string_view sample; // First line seen, stored in the table's arena
+    };
+
+    // Templates of one chunk (or the merged result), all strings live in its arena
+    class PatternTable
+    {
+    public:
+        PatternTable() : arena(std::make_unique<MonotonicArena>()), templates(*arena) {}
+
+        void record(std::string_view templ, const std::optional<TimePoint>& ts, std::string_view line)
+        {
+            TemplateStats& entry = find_or_add(templ, line);
+            ++entry.count;
+            if (ts)
+            {
+                if (!entry.first)
+                    entry.first = ts;
+                entry.last = ts;
+            }
+        }
+
+        // Chunks are merged in file order, so the other table's timestamps come later
+        void merge(const PatternTable& other)
+        {
+            for (std::size_t id = 0; id < other.stats.size(); ++id)
+            {
+                const TemplateStats& theirs = other.stats[id];
+                TemplateStats& entry = find_or_add(other.templates.get(static_cast<StringInterner::Id>(id)), theirs.sample);
+
+                entry.count += theirs.count;
+                if (!entry.first)
+                    entry.first = theirs.first;
+                if (theirs.last)
+                    entry.last = theirs.last;
+            }
+            matchedLines += other.matchedLines;
+        }
+
+        std::unique_ptr<MonotonicArena> arena; // Heap-allocated so views stay valid when the table moves
+        StringInterner templates;
+        std::vector<TemplateStats> stats;      // Indexed by template id
+        std::uint64_t matchedLines {0};
+
+    private:
+        TemplateStats& find_or_add(std::string_view templ, std::string_view sample)
+        {
+            StringInterner::Id id = templates.intern(templ);
+            if (id == stats.size())
+            {
+                stats.push_back({0, std::nullopt, std::nullopt, arena->copy(sample)});
+            }
+            return stats[id];
+        }
+    };
+
+    PatternTable process_chunk(const ProgramOptions& options, const LineMatcher& matcher, const FileChunk& chunk)
+    {
+        std::ifstream inputFile(options.inputFilePath, std::ios::binary);
+        if (!inputFile.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + options.inputFilePath);
+        }
+
+        PatternTable table;
+        std::string normalized; // Reused for every line
+        std::optional<TimePoint> lastTimestamp;
+
+        read_chunk_lines(inputFile, chunk, [&](const std::string& line)
+        {
+            // Track every timestamped line, matching or not, for the continuation lines below
+            auto ts = extract_timestamp(line, options.detectedDateFormat);
+            if (ts)
+            {
+                lastTimestamp = ts;
+            }
+
+            if (!matcher.within_date_range(ts) || !matcher.matches(line))
+            {
+                return;
+            }
+            ++table.matchedLines;
+
+            std::string_view message = ts ? strip_timestamp(line) : std::string_view(line);
+
+            normalize_line(message, normalized);
+
+            // Lines without a timestamp (stack traces etc.) belong to the last timestamped line
+            table.record(normalized, lastTimestamp, line);
+        });
+
+        return table;
+    }
+}
+
+void normalize_line(std::string_view line, std::string& out)
+{
+    out.clear();
+
+    std::size_t pos = 0;
+    while (pos < line.size())
+    {
+        char c = line[pos];
+        if (!is_alnum(c))
+        {
+            out.push_back(c);
+            ++pos;
+            continue;
+        }
+
+        // Multi-word tokens first, they contain separators
+        if (std::size_t length = match_uuid(line, pos))
+        {
+            out.append("<UUID>");
+            pos += length;
+            continue;
+        }
+        if (std::size_t length = match_ipv4(line, pos))
+        {
+            out.append("<IP>");
+            pos += length;
+            continue;
+        }
+
+        std::size_t end = pos;
+        while (end < line.size() && is_alnum(line[end]))
+            ++end;
+
+        normalize_word(line.substr(pos, end - pos), out);
+        pos = end;
+    }
+}
+
+int cluster_patterns(const ProgramOptions& options)
+{
+    /*
+    * TEMPLATE CLUSTERING
+    *
+    * 1. Each matching line has its timestamp stripped and its variable tokens replaced
+    *    (normalize_line), the result is the line's template
+    * 2. Templates are interned into a per-thread arena, so a repeated template costs one
+    *    hash lookup and no allocation; new ones are copied once along with a sample line
+    * 3. Chunks run in parallel (-j) and their tables are merged in file order
+    * 4. Templates are printed by count, with first/last timestamp and the sample line
+    */
+
+    const LineMatcher matcher(options);
+    auto chunks = split_into_line_chunks(options.inputFilePath, static_cast<std::size_t>(options.threadCount));
+
+    std::vector<std::future<PatternTable>> workers;
+    workers.reserve(chunks.size());
+    for (const auto& chunk : chunks)
+    {
+        workers.push_back(std::async(std::launch::async, process_chunk, std::cref(options), std::cref(matcher), chunk));
+    }
+
+    PatternTable merged;
+    for (auto& worker : workers)
+    {
+        merged.merge(worker.get()); // Rethrows worker exceptions
+    }
+
+    std::vector<StringInterner::Id> order(merged.stats.size());
+    for (std::size_t id = 0; id < order.size(); ++id)
+    {
+        order[id] = static_cast<StringInterner::Id>(id);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](StringInterner::Id a, StringInterner::Id b)
+    {
+        return merged.stats[a].count > merged.stats[b].count;
+    });
+
+    for (StringInterner::Id id : order)
+    {
+        const TemplateStats& entry = merged.stats[id];
+        auto color = get_log_level_color(detect_log_level(entry.sample, options.logFormat));
+
+        std::cout << color << "[" << std::setw(8) << entry.count << "] " << merged.templates.get(id) << RESET_COLOR << '\n';
+        if (entry.first)
+        {
+            std::cout << "           first: " << format_timestamp(*entry.first)
+                      << "  last: " << format_timestamp(*entry.last) << '\n';
+        }
+        std::cout << "           e.g.   " << entry.sample << '\n';
+    }
+
+    std::cout << "\nTotal Patterns: " << merged.stats.size() << " (" << merged.matchedLines << " matching lines)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
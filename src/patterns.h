@@ -0,0 +1,23 @@
+// src/patterns.h
+
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include <string>
+#include <string_view>
+#include "arg_parser.h"
+
+// Hex tokens shorter than this are kept as words (so "cafe" or "add" survive)
+constexpr std::size_t HEX_TOKEN_MIN_LENGTH {6};
+
+// Mixed letter/digit tokens at least this long are treated as opaque ids (tokens, hashes)
+constexpr std::size_t OPAQUE_TOKEN_MIN_LENGTH {16};
+
+// Replaces variable tokens with placeholders: <NUM>, <HEX>, <UUID>, <IP>, <ID>
+// Ex: "Cache miss: key=user_profile_3241" -> "Cache miss: key=user_profile_<NUM>"
+void normalize_line(std::string_view line, std::string& out);
+
+// Groups matching lines into message templates and prints them by frequency
+int cluster_patterns(const ProgramOptions& options);
+
+#endif // PATTERNS_H
@@ -0,0 +1,183 @@
+// src/sampler.cpp
+
+#include "sampler.h"
+#include "chunk_reader.h"
+#include "matcher.h"
+#include "utils.h"
+#include "date.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    constexpr std::size_t LEVEL_COUNT {static_cast<std::size_t>(LogLevel::UNKNOWN) + 1};
+
+    struct BlockStats
+    {
+        std::uintmax_t bytes {0};
+        std::uintmax_t matches {0};
+        std::array<std::uintmax_t, LEVEL_COUNT> levelMatches {};
+    };
+
+    struct Estimate
+    {
+        double total {0.0};
+        double margin {0.0}; // Half-width of the confidence interval
+    };
+
+    /*
+    * Ratio estimator for cluster samples (each block is one cluster):
+    *   R     = sum(m_i) / sum(b_i)              matches per byte
+    *   total = R * fileSize
+    *   s^2   = sum((m_i - R * b_i)^2) / (n - 1)
+    *   var   = fileSize^2 * (1 - f) * s^2 / (n * mean(b)^2)
+    * where f is the sampled fraction of the file (finite population correction).
+    */
+    template <typename CountOf>
+    Estimate estimate_total(const std::vector<BlockStats>& blocks, std::uintmax_t fileSize, CountOf countOf)
+    {
+        double sampledBytes {0.0};
+        double sampledMatches {0.0};
+        for (const auto& block : blocks)
+        {
+            sampledBytes += static_cast<double>(block.bytes);
+            sampledMatches += static_cast<double>(countOf(block));
+        }
+
+        Estimate result;
+        if (sampledBytes == 0.0)
+        {
+            return result;
+        }
+
+        const double ratio = sampledMatches / sampledBytes;
+        const double size = static_cast<double>(fileSize);
+        result.total = ratio * size;
+
+        const double n = static_cast<double>(blocks.size());
+        const double fraction = sampledBytes / size;
+        if (blocks.size() < 2 || fraction >= 1.0)
+        {
+            return result; // Whole file was read, or too few blocks for a variance
+        }
+
+        double sumSquares {0.0};
+        for (const auto& block : blocks)
+        {
+            double residual = static_cast<double>(countOf(block)) - ratio * static_cast<double>(block.bytes);
+            sumSquares += residual * residual;
+        }
+
+        const double meanBytes = sampledBytes / n;
+        const double variance = size * size * (1.0 - fraction) * (sumSquares / (n - 1.0)) / (n * meanBytes * meanBytes);
+        result.margin = SAMPLE_CONFIDENCE_Z * std::sqrt(variance);
+        return result;
+    }
+
+    void print_estimate(const char* label, const Estimate& estimate)
+    {
+        std::cout << label << std::llround(estimate.total)
+                  << " ± " << std::llround(estimate.margin) << '\n';
+    }
+}
+
+int sample_file(const ProgramOptions& options)
+{
+    /*
+    * SAMPLING ALGORITHM
+    *
+    * 1. Split the file into N equal strides and read one block from the start of each
+    * 2. Every block starts on a line boundary (the partial line at the seek offset is skipped)
+    *    and reads whole lines until SAMPLE_BLOCK_SIZE bytes are consumed
+    * 3. Lines are matched exactly like search_in_file (patterns + date range)
+    * 4. Matches per byte are scaled up to the file size, see estimate_total()
+    *
+    * If N blocks cover the whole file anyway, it is read once and the counts are exact.
+    */
+
+    std::ifstream inputFile(options.inputFilePath, std::ios::binary);
+
+    if (!inputFile.is_open())
+    {
+        throw std::runtime_error("Failed to open file: " + options.inputFilePath);
+    }
+
+    const std::uintmax_t fileSize = get_file_size(options.inputFilePath);
+    const LineMatcher matcher(options);
+
+    std::uintmax_t blockCount = static_cast<std::uintmax_t>(options.sampleBlocks);
+    std::uintmax_t blockSize = SAMPLE_BLOCK_SIZE;
+    if (blockCount * blockSize >= fileSize)
+    {
+        blockCount = 1;
+        blockSize = fileSize;
+    }
+    const std::uintmax_t stride = fileSize / blockCount;
+
+    std::vector<BlockStats> blocks;
+    blocks.reserve(blockCount);
+
+    std::string line;
+
+    for (std::uintmax_t i = 0; i < blockCount; ++i)
+    {
+        BlockStats block;
+        seek_to_line_start(inputFile, i * stride, fileSize);
+
+        while (block.bytes < blockSize && std::getline(inputFile, line))
+        {
+            block.bytes += line.size() + 1; // +1 for the newline consumed by getline
+
+            auto ts = extract_timestamp(line, options.detectedDateFormat);
+            if (!matcher.within_date_range(ts) || !matcher.matches(line))
+            {
+                continue;
+            }
+
+            ++block.matches;
+            ++block.levelMatches[static_cast<std::size_t>(detect_log_level(line, options.logFormat))];
+        }
+
+        blocks.push_back(block);
+    }
+
+    std::uintmax_t sampledBytes {0};
+    std::uintmax_t sampledMatches {0};
+    for (const auto& block : blocks)
+    {
+        sampledBytes += block.bytes;
+        sampledMatches += block.matches;
+    }
+
+    const double percent = fileSize ? 100.0 * static_cast<double>(sampledBytes) / static_cast<double>(fileSize) : 100.0;
+
+    std::cout << "Sampled " << blocks.size() << " block(s): " << sampledBytes << " of " << fileSize
+              << " bytes (" << std::fixed << std::setprecision(2) << percent << "%), "
+              << sampledMatches << " matching line(s)\n";
+
+    print_estimate("\nEstimated Total Matches: ",
+                   estimate_total(blocks, fileSize, [](const BlockStats& b) { return b.matches; }));
+
+    for (std::size_t level = 0; level < LEVEL_COUNT; ++level)
+    {
+        auto estimate = estimate_total(blocks, fileSize, [level](const BlockStats& b) { return b.levelMatches[level]; });
+        if (estimate.total == 0.0)
+        {
+            continue;
+        }
+
+        auto logLevel = static_cast<LogLevel>(level);
+        std::cout << get_log_level_color(logLevel) << "  " << std::left << std::setw(8) << get_log_level_name(logLevel)
+                  << RESET_COLOR;
+        print_estimate("", estimate);
+    }
+
+    std::cout << "\n(" << SAMPLE_CONFIDENCE_PERCENT << "% confidence intervals)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,18 @@
+// src/sampler.h
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include "arg_parser.h"
+
+// Bytes read per sampled block (rounded up to the next full line)
+constexpr std::size_t SAMPLE_BLOCK_SIZE {64 * 1024};
+
+// Reported confidence interval and its z-score
+constexpr int SAMPLE_CONFIDENCE_PERCENT {95};
+constexpr double SAMPLE_CONFIDENCE_Z {1.96};
+
+// Approximate match counting: reads evenly spaced blocks instead of the whole file
+int sample_file(const ProgramOptions& options);
+
+#endif // SAMPLER_H
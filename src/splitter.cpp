@@ -0,0 +1,391 @@
+// src/splitter.cpp
+
+#include "splitter.h"
+#include "chunk_reader.h"
+#include "matcher.h"
+#include "date.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <future>
+#include <exception>
+#include <map>
+#include <algorithm>
+#include <set>
+#include <optional>
+#include <ctime>
+#include <cstdlib>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    struct WindowBounds
+    {
+        std::time_t start {0};
+        std::time_t end {0}; // Exclusive
+    };
+
+    // Local-time window containing t. Windows are aligned to midnight, so when the
+    // window length does not divide a day the last one is cut short at midnight.
+    WindowBounds window_bounds(std::time_t t, int windowMinutes)
+    {
+        std::tm tm = {};
+        localtime_r(&t, &tm);
+
+        int minuteOfDay = tm.tm_hour * 60 + tm.tm_min;
+        int start = minuteOfDay / windowMinutes * windowMinutes;
+        int end = std::min(start + windowMinutes, MAX_SPLIT_WINDOW_MINUTES);
+
+        // Both ends go through mktime, so DST days (23 or 25 hours) are handled
+        tm.tm_sec = 0;
+        tm.tm_hour = start / 60;
+        tm.tm_min = start % 60;
+        tm.tm_isdst = -1; // Let mktime determine if DST is in effect
+        std::tm endTm = tm;
+        std::time_t startTime = std::mktime(&tm);
+
+        endTm.tm_hour = end / 60; // 24:00 is normalized to the next day's midnight
+        endTm.tm_min = end % 60;
+        return {startTime, std::mktime(&endTm)};
+    }
+
+    // Ex: server.log, window 2025-10-21 08:00 -> <dir>/server_20251021_0800.log
+    fs::path window_file_path(const ProgramOptions& options, std::time_t window)
+    {
+        std::tm tm = {};
+        localtime_r(&window, &tm);
+
+        char label[sizeof("YYYYMMDD_HHMM")];
+        std::strftime(label, sizeof(label), "%Y%m%d_%H%M", &tm);
+
+        fs::path input(options.inputFilePath);
+        std::string extension = input.has_extension() ? input.extension().string() : ".log";
+        return fs::path(options.outputDirectory) / (input.stem().string() + "_" + label + extension);
+    }
+
+    fs::path untimed_file_path(const ProgramOptions& options)
+    {
+        fs::path input(options.inputFilePath);
+        std::string extension = input.has_extension() ? input.extension().string() : ".log";
+        return fs::path(options.outputDirectory) / (input.stem().string() + "_untimed" + extension);
+    }
+
+    void append_to_file(const fs::path& path, const std::string& data, bool truncate = false)
+    {
+        std::ofstream out(path, std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+        if (!out.write(data.data(), static_cast<std::streamsize>(data.size())))
+        {
+            throw std::runtime_error("Failed to write file: " + path.string());
+        }
+    }
+
+    // Lines of one window from one chunk, spilled to disk whenever the buffer is full
+    // or the chunk moves on to another window. The first chunk writes the window file
+    // directly, later chunks write a part file that is merged afterwards.
+    struct WindowPart
+    {
+        fs::path path;
+        bool isPartFile {false};
+        std::string buffer;
+        std::uint64_t lines {0};
+        bool spilled {false};
+
+        void flush()
+        {
+            if (buffer.empty())
+                return;
+            append_to_file(path, buffer, !spilled);
+            spilled = true;
+            buffer.clear(); // Keeps capacity for the next batch
+        }
+
+        // Called when lines move on to another window: write out and free the buffer,
+        // so only the current window's buffer is held in memory
+        void release()
+        {
+            flush();
+            std::string().swap(buffer);
+        }
+    };
+
+    struct ChunkOutput
+    {
+        std::map<std::time_t, WindowPart> parts;
+        WindowPart leading;                     // Matching lines before the chunk's first timestamp
+        std::optional<std::time_t> lastWindow;  // Window of the chunk's last timestamped line
+    };
+
+    // Deletes part files that were not merged (error paths)
+    void remove_part_files(const ChunkOutput& output)
+    {
+        auto remove_part = [](const WindowPart& part)
+        {
+            if (part.isPartFile)
+            {
+                std::error_code ec;
+                fs::remove(part.path, ec); // Ignore files that were never created or already merged
+            }
+        };
+
+        remove_part(output.leading);
+        for (const auto& [window, part] : output.parts)
+        {
+            remove_part(part);
+        }
+    }
+
+    void route_chunk_lines(const ProgramOptions& options, const LineMatcher& matcher,
+                           const FileChunk& chunk, std::size_t chunkIndex, ChunkOutput& output)
+    {
+        std::ifstream inputFile(options.inputFilePath, std::ios::binary);
+        if (!inputFile.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + options.inputFilePath);
+        }
+
+        // Consecutive lines nearly always fall in the same window, so remember its bounds
+        std::optional<std::time_t> currentWindow;
+        std::time_t currentEnd {0};
+        WindowPart* currentPart {nullptr};
+
+        read_chunk_lines(inputFile, chunk, [&](const std::string& line)
+        {
+            auto ts = extract_timestamp(line, options.detectedDateFormat);
+            if (ts)
+            {
+                if (!currentWindow)
+                {
+                    output.leading.release(); // No more lines can precede the first timestamp
+                }
+
+                std::time_t t = std::chrono::system_clock::to_time_t(*ts);
+                if (!currentWindow || t < *currentWindow || t >= currentEnd)
+                {
+                    WindowBounds bounds = window_bounds(t, options.splitWindowMinutes);
+                    currentWindow = bounds.start;
+                    currentEnd = bounds.end;
+                    if (currentPart)
+                    {
+                        currentPart->release();
+                        currentPart = nullptr; // Looked up on the next matching line
+                    }
+                }
+            }
+
+            if (!matcher.within_date_range(ts) || !matcher.matches(line))
+            {
+                return;
+            }
+
+            // Lines without a timestamp (stack traces etc.) follow the last timestamped line
+            if (!currentWindow)
+            {
+                output.leading.buffer.append(line).push_back('\n');
+                ++output.leading.lines;
+                if (output.leading.buffer.size() >= SPLIT_BUFFER_SIZE)
+                {
+                    output.leading.flush();
+                }
+                return;
+            }
+
+            if (!currentPart)
+            {
+                auto [it, inserted] = output.parts.try_emplace(*currentWindow);
+                if (inserted)
+                {
+                    // Chunk 0 always comes first in the merge, so it can write the final file
+                    it->second.path = window_file_path(options, *currentWindow);
+                    if (chunkIndex > 0)
+                    {
+                        it->second.path += ".part" + std::to_string(chunkIndex);
+                        it->second.isPartFile = true;
+                    }
+                }
+                currentPart = &it->second;
+            }
+
+            currentPart->buffer.append(line).push_back('\n');
+            ++currentPart->lines;
+            if (currentPart->buffer.size() >= SPLIT_BUFFER_SIZE)
+            {
+                currentPart->flush();
+            }
+        });
+
+        output.leading.flush();
+        for (auto& [window, part] : output.parts)
+        {
+            part.flush();
+        }
+        output.lastWindow = currentWindow;
+    }
+
+    ChunkOutput process_chunk(const ProgramOptions& options, const LineMatcher& matcher,
+                              const FileChunk& chunk, std::size_t chunkIndex)
+    {
+        ChunkOutput output;
+
+        // Leading lines go to the previous chunk's last window, which is only known at
+        // merge time, so they get a part file too. Chunk 0 has no previous chunk: <name>_untimed.
+        output.leading.path = untimed_file_path(options);
+        if (chunkIndex > 0)
+        {
+            output.leading.path += ".part" + std::to_string(chunkIndex);
+            output.leading.isPartFile = true;
+        }
+
+        try
+        {
+            route_chunk_lines(options, matcher, chunk, chunkIndex, output);
+        }
+        catch (...)
+        {
+            remove_part_files(output); // Don't leave .part files behind
+            throw;
+        }
+        return output;
+    }
+}
+
+int split_by_time_window(const ProgramOptions& options)
+{
+    /*
+    * TIME WINDOW SPLITTING
+    *
+    * 1. The file is split into line-aligned chunks processed in parallel (-j)
+    * 2. Each chunk routes matching lines by extract_timestamp() into a buffer per window
+    *    and spills it when the buffer is full or the next window starts, so at most one
+    *    window buffer per thread is in memory. The first chunk writes the window files
+    *    directly, the others write their own part files (<window file>.part<chunk>), so
+    *    threads never share a file
+    * 3. Afterwards the parts are merged in chunk order, which keeps the original line
+    *    order inside every window. A part that is the first content of its window is just
+    *    renamed, so for time-ordered logs most matched bytes are written only once
+    *
+    * Lines without a timestamp belong to the window of the previous timestamped line,
+    * even across chunk boundaries; those before any timestamp go to <name>_untimed.
+    */
+
+    std::error_code ec;
+    fs::create_directories(options.outputDirectory, ec);
+    if (ec)
+    {
+        throw std::runtime_error("Failed to create output directory: " + options.outputDirectory);
+    }
+
+    const LineMatcher matcher(options);
+    auto chunks = split_into_line_chunks(options.inputFilePath, static_cast<std::size_t>(options.threadCount));
+
+    std::vector<std::future<ChunkOutput>> workers;
+    workers.reserve(chunks.size());
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        workers.push_back(std::async(std::launch::async, process_chunk, std::cref(options), std::cref(matcher), chunks[i], i));
+    }
+
+    // Collect every worker, even after a failure, so all part files can be cleaned up
+    std::vector<ChunkOutput> outputs;
+    outputs.reserve(workers.size());
+    std::exception_ptr failure;
+    for (auto& worker : workers)
+    {
+        try
+        {
+            outputs.push_back(worker.get()); // Rethrows worker exceptions
+        }
+        catch (...)
+        {
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
+
+    // Merge in file order. Files written by this run start truncated, later parts are appended.
+    std::map<fs::path, std::uint64_t> writtenFiles;
+    std::optional<std::time_t> carriedWindow;
+
+    // Moves one chunk's lines for a window onto the end of the target file
+    auto merge_part = [&](const WindowPart& part, const fs::path& target)
+    {
+        if (part.lines == 0)
+            return;
+
+        bool firstWrite = writtenFiles.find(target) == writtenFiles.end();
+
+        if (!part.isPartFile)
+        {
+            // Written in place by the first chunk
+        }
+        else if (firstWrite)
+        {
+            fs::rename(part.path, target); // Nothing to append to, no copy needed
+        }
+        else
+        {
+            std::ifstream partFile(part.path, std::ios::binary);
+            std::ofstream out(target, std::ios::binary | std::ios::app);
+            if (!partFile.is_open() || !(out << partFile.rdbuf()))
+            {
+                throw std::runtime_error("Failed to write file: " + target.string());
+            }
+            partFile.close();
+            fs::remove(part.path);
+        }
+
+        writtenFiles[target] += part.lines;
+    };
+
+    bool foundTimestamps {false};
+
+    try
+    {
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+
+        for (auto& output : outputs)
+        {
+            merge_part(output.leading, carriedWindow ? window_file_path(options, *carriedWindow) : untimed_file_path(options));
+
+            for (auto& [window, part] : output.parts)
+            {
+                merge_part(part, window_file_path(options, window));
+            }
+
+            if (output.lastWindow)
+            {
+                carriedWindow = output.lastWindow;
+                foundTimestamps = true;
+            }
+        }
+    }
+    catch (...)
+    {
+        for (const auto& output : outputs)
+        {
+            remove_part_files(output);
+        }
+        throw;
+    }
+
+    // Same warning as search_in_file gives for -from/-to
+    if (!foundTimestamps)
+    {
+        std::cerr << "\nWarning: --split-by was requested, but no valid timestamps were found in the log lines. "
+                  << "All matches were written to " << untimed_file_path(options).string() << ".\n";
+    }
+
+    std::uint64_t totalLines {0};
+    for (const auto& [path, lines] : writtenFiles)
+    {
+        std::cout << path.string() << ": " << lines << " line(s)\n";
+        totalLines += lines;
+    }
+
+    std::cout << "\nTotal Matches: " << totalLines << " in " << writtenFiles.size() << " file(s)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,17 @@
+// src/splitter.h
+
+#ifndef SPLITTER_H
+#define SPLITTER_H
+
+#include "arg_parser.h"
+
+// Output buffered per window before it is written to disk
+constexpr std::size_t SPLIT_BUFFER_SIZE {1024 * 1024};
+
+// Longest window: one day (windows restart at midnight)
+constexpr int MAX_SPLIT_WINDOW_MINUTES {24 * 60};
+
+// Writes matching lines into one file per time window (--split-by)
+int split_by_time_window(const ProgramOptions& options);
+
+#endif // SPLITTER_H
@@ -3,36 +3,36 @@
 #include "utils.h"
 #include <algorithm>
 
-LogLevel detect_log_level(const std::string& line, const LogLevelConfig& config)
+LogLevel detect_log_level(std::string_view line, const LogLevelConfig& config)
 {
-    std::string lowerLine = to_lower(line);
+    // Compare against the line in place instead of lowering a copy of it (no allocation per line)
 
     for (const auto& keyword : config.fatalKeywords) {
-        if (lowerLine.find(keyword) != std::string::npos) {
+        if (contains_ignore_case(line, keyword)) {
             return LogLevel::FATAL;
         }
     }
 
     for (const auto& keyword : config.errorKeywords) {
-        if (lowerLine.find(keyword) != std::string::npos) {
+        if (contains_ignore_case(line, keyword)) {
             return LogLevel::ERROR;
         }
     }
 
     for (const auto& keyword : config.warningKeywords) {
-        if (lowerLine.find(keyword) != std::string::npos) {
+        if (contains_ignore_case(line, keyword)) {
             return LogLevel::WARNING;
         }
     }
 
     for (const auto& keyword : config.infoKeywords) {
-        if (lowerLine.find(keyword) != std::string::npos) {
+        if (contains_ignore_case(line, keyword)) {
             return LogLevel::INFO;
         }
     }
 
     for (const auto& keyword : config.debugKeywords) {
-        if (lowerLine.find(keyword) != std::string::npos) {
+        if (contains_ignore_case(line, keyword)) {
             return LogLevel::DEBUG;
         }
     }
@@ -59,6 +59,24 @@ const char* get_log_level_color(LogLevel level)
     }
 }
 
+const char* get_log_level_name(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::FATAL:
+            return "FATAL";
+        case LogLevel::ERROR:
+            return "ERROR";
+        case LogLevel::WARNING:
+            return "WARNING";
+        case LogLevel::INFO:
+            return "INFO";
+        case LogLevel::DEBUG:
+            return "DEBUG";
+        default:
+            return "UNKNOWN";
+    }
+}
+
 std::string to_lower(const std::string& str)
 {
     std::string result = str;
@@ -66,4 +84,29 @@ std::string to_lower(const std::string& str)
                    [](unsigned char c){ return std::tolower(c); });
     
     return result;
-}
\ No newline at end of file
+}
+
+// Same result as to_lower(text).find(lowerNeedle) != npos, without building the lowered copy
+bool contains_ignore_case(std::string_view text, std::string_view lowerNeedle)
+{
+    if (lowerNeedle.empty())
+        return true;
+
+    // ASCII lowering inline, std::tolower is a library call per character
+    // (the program never calls setlocale, so both agree)
+    auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; };
+
+    const char first = lowerNeedle[0];
+    for (std::size_t i = 0; i + lowerNeedle.size() <= text.size(); ++i)
+    {
+        if (lower(text[i]) != first)
+            continue;
+
+        std::size_t j = 1;
+        while (j < lowerNeedle.size() && lower(text[i + j]) == lowerNeedle[j])
+            ++j;
+        if (j == lowerNeedle.size())
+            return true;
+    }
+    return false;
+}
@@ -4,6 +4,7 @@
 #define UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 // ANSI color codes for terminal text formatting
@@ -69,8 +70,10 @@ namespace LogFormats {
 inline const LogLevelConfig& DEFAULT_LOG_LEVEL_CONFIG = LogFormats::GENERIC;
 
 // Utility Functions
-LogLevel detect_log_level(const std::string& line, const LogLevelConfig& config);
+LogLevel detect_log_level(std::string_view line, const LogLevelConfig& config);
 const char* get_log_level_color(LogLevel level);
+const char* get_log_level_name(LogLevel level);
 std::string to_lower(const std::string& str);
+bool contains_ignore_case(std::string_view text, std::string_view lowerNeedle);
 
 #endif // UTILS_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+// tests/alloc_counter.cpp
+// Linked into the check build only: counts every operator new and prints the
+// total to stderr at exit, so tests/check_allocations.sh can compare runs.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<unsigned long> allocationCount {0};
+
+    struct AllocationReport
+    {
+        ~AllocationReport() { std::fprintf(stderr, "allocations: %lu\n", allocationCount.load()); }
+    } report;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
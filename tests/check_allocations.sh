@@ -0,0 +1,40 @@
+#!/bin/sh
+# tests/check_allocations.sh <logparser built with tests/alloc_counter.cpp>
+#
+# The search loop, and the heavy hitter loop while no value is evicted, must not
+# allocate per line: the same query over N and 4N lines has to report the same
+# allocation count.
+
+BINARY=${1:?usage: check_allocations.sh <binary>}
+LINES=1000
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+head -n "$LINES" sample_log_file_long.txt > "$WORK/small.log"
+for i in 1 2 3 4; do cat "$WORK/small.log"; done > "$WORK/large.log"
+
+count_allocations()
+{
+    "$BINARY" "$@" 2>&1 >/dev/null | sed -n 's/^allocations: //p'
+}
+
+failed=0
+check()
+{
+    small=$(count_allocations "$WORK/small.log" "$@")
+    large=$(count_allocations "$WORK/large.log" "$@")
+    if [ -n "$small" ] && [ "$small" = "$large" ]; then
+        echo "ok:   $* ($small allocations)"
+    else
+        echo "FAIL: $* ($LINES lines: ${small:-?}, $((LINES * 4)) lines: ${large:-?})"
+        failed=1
+    fi
+}
+
+check ERROR
+check error -i
+check ERROR -B 3 -A 2
+check WARN -from "2025-10-21 08:40:00"
+check "" --field userId -j 1
+
+exit $failed